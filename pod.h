@@ -33,3 +33,31 @@ struct Pod {
     QString website;
     QString hash;
 };
+
+/**
+ * Result of validating a single installed pod.
+ * @see PodManager::checkPods
+ */
+struct PodCheckReport {
+    PodCheckReport()
+        : isLowerCase(false),
+          exists(false),
+          hasLicense(false),
+          hasReadme(false),
+          hasPri(false),
+          hasPro(false) {
+    }
+
+    QString name;
+
+    bool isLowerCase;
+    bool exists;
+    bool hasLicense;
+    bool hasReadme;
+    bool hasPri;
+    bool hasPro;
+
+    bool isValid() const {
+        return isLowerCase && exists && hasLicense && hasReadme && hasPri && hasPro;
+    }
+};
@@ -30,10 +30,84 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QEventLoop>
+#include <QDirIterator>
+#include <QRegularExpression>
+#include <QtConcurrentMap>
+
+namespace {
+
+// Match QFile::exists, which is case-insensitive on these platforms
+#if defined(Q_OS_MAC) || defined(Q_OS_WIN)
+const Qt::CaseSensitivity fileNameCaseSensitivity = Qt::CaseInsensitive;
+#else
+const Qt::CaseSensitivity fileNameCaseSensitivity = Qt::CaseSensitive;
+#endif
+
+/** Fills in a pod report from a single listing of the pod directory. */
+struct PodDirectoryInspector {
+    PodDirectoryInspector(QString repositoryPath)
+        : repositoryPath(repositoryPath) {
+    }
+
+    void operator()(PodCheckReport& report) const {
+        QDir dir(QDir(repositoryPath).filePath(report.name));
+
+        // Nested pods are not covered by the repository listing
+        if(report.name.contains('/')) {
+            report.exists = dir.exists();
+        }
+
+        if(!report.exists) {
+            return;
+        }
+
+        // Like QFile::exists, accept any kind of entry
+        QStringList entries = dir.entryList(QDir::AllEntries | QDir::Hidden | QDir::System);
+        report.hasLicense   = entries.contains("LICENSE", fileNameCaseSensitivity);
+        report.hasReadme    = entries.contains("README.md", fileNameCaseSensitivity);
+        report.hasPri       = entries.contains(report.name + ".pri", fileNameCaseSensitivity);
+        report.hasPro       = entries.contains(report.name + ".pro", fileNameCaseSensitivity);
+    }
+
+    QString repositoryPath;
+};
+
+/** @returns the size of all regular files below path, not following symlinks. */
+qint64 directorySize(QString path) {
+    qint64 size = 0;
+    QDirIterator it(path,
+                    QDir::Files | QDir::Hidden | QDir::System | QDir::NoSymLinks,
+                    QDirIterator::Subdirectories);
+    while(it.hasNext()) {
+        it.next();
+        size += it.fileInfo().size();
+    }
+    return size;
+}
+
+/** @returns true if modulePath is a parent directory of a registered module. */
+bool isParentOfModule(QString modulePath, QStringList moduleNames) {
+    foreach(QString moduleName, moduleNames) {
+        if(moduleName.startsWith(modulePath + "/")) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/** @returns the canonical path if it exists, the cleaned absolute path otherwise. */
+QString resolvePath(QString path) {
+    QFileInfo fileInfo(path);
+    QString canonicalPath = fileInfo.canonicalFilePath();
+    return canonicalPath.isEmpty() ? QDir::cleanPath(fileInfo.absoluteFilePath()) : canonicalPath;
+}
+
+}
 
 PodManager::PodManager(QObject *parent)
     : QObject(parent) {
     qRegisterMetaType<QList<Pod> >("QList<Pod>");
+    qRegisterMetaType<QList<PodCheckReport> >("QList<PodCheckReport>");
     _networkAccessManager = new QNetworkAccessManager(this);
 }
 
@@ -370,6 +444,129 @@ bool PodManager::checkPod(QString repository, QString podName) {
     return isValidPod;
 }
 
+QList<PodCheckReport> PodManager::checkPods(QString repository) {
+    // Resolve the path up front, the worker threads must not depend
+    // on the current directory
+    QDir dir(repository);
+    QString repositoryPath = dir.absolutePath();
+
+    // A single listing of the repository tells us which pods exist
+    QStringList directories = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden);
+
+    QList<PodCheckReport> reports;
+    QMap<QString, QString> submodules;
+    readSubmodules(repository, submodules);
+    foreach(QString podName, submodules.values()) {
+        PodCheckReport report;
+        report.name         = podName;
+        report.isLowerCase  = (podName == podName.toLower());
+        report.exists       = directories.contains(podName, fileNameCaseSensitivity);
+        reports.append(report);
+    }
+
+    QtConcurrent::blockingMap(reports, PodDirectoryInspector(repositoryPath));
+
+    emit checkPodsFinished(repository, reports);
+    return reports;
+}
+
+qint64 PodManager::prunePods(QString repository) {
+    if(!isGitRepository(repository)) {
+        emit prunePodsFinished(repository, 0);
+        return 0;
+    }
+
+    // Without a readable .gitmodules we cannot tell what is still in use
+    QMap<QString, QString> submodules;
+    if(!readSubmodules(repository, submodules)) {
+        emit prunePodsFinished(repository, 0);
+        return 0;
+    }
+
+    // Git names module stores after the submodule name, not its path
+    QStringList moduleNames = submodules.keys();
+    QStringList podPaths = submodules.values();
+
+    QDir dir(repository);
+    QString modulesPath = resolvePath(dir.filePath(".git/modules"));
+    qint64 bytesFreed = 0;
+
+    // Pod checkouts that are no longer registered. Only consider directories
+    // whose .git link file points into this repository's module stores, so
+    // worktrees and repositories with a separate git dir are left alone.
+    QStringList directories = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden);
+    foreach(QString directory, directories) {
+        if(directory == ".git" || podPaths.contains(directory)) {
+            continue;
+        }
+
+        QString checkoutPath = dir.filePath(directory);
+        QFile gitLink(QDir(checkoutPath).filePath(".git"));
+        if(!QFileInfo(gitLink.fileName()).isFile() || !gitLink.open(QFile::ReadOnly | QFile::Text)) {
+            continue;
+        }
+
+        QString gitDir;
+        while(!gitLink.atEnd()) {
+            QString line = QString::fromUtf8(gitLink.readLine()).trimmed();
+            if(line.startsWith("gitdir:")) {
+                gitDir = line.mid(7).trimmed();
+                break;
+            }
+        }
+        gitLink.close();
+
+        if(gitDir.isEmpty()) {
+            continue;
+        }
+
+        QString gitDirPath = resolvePath(QDir(checkoutPath).absoluteFilePath(gitDir));
+        if(!gitDirPath.startsWith(modulesPath + "/", fileNameCaseSensitivity)) {
+            continue;
+        }
+
+        // Leave checkouts alone that still share a store with a registered pod
+        QString moduleName = gitDirPath.mid(modulesPath.length() + 1);
+        bool isInUse = isParentOfModule(moduleName, moduleNames);
+        foreach(QString registeredName, moduleNames) {
+            isInUse = isInUse ||
+                moduleName == registeredName ||
+                moduleName.startsWith(registeredName + "/");
+        }
+
+        if(!isInUse) {
+            bytesFreed += removeDirectory(checkoutPath);
+        }
+    }
+
+    // Module object stores of pods that have been removed. Stores of
+    // nested submodules live in subdirectories, so descend into every
+    // directory that is a parent of a registered module.
+    QStringList pendingModules;
+    QDir modulesDir(modulesPath);
+    pendingModules << modulesDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden);
+    while(!pendingModules.isEmpty()) {
+        QString modulePath = pendingModules.takeFirst();
+        if(moduleNames.contains(modulePath)) {
+            continue;
+        }
+
+        if(isParentOfModule(modulePath, moduleNames)) {
+            QStringList children = QDir(modulesDir.filePath(modulePath))
+                .entryList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden);
+            foreach(QString child, children) {
+                pendingModules.append(modulePath + "/" + child);
+            }
+            continue;
+        }
+
+        bytesFreed += removeDirectory(modulesDir.filePath(modulePath));
+    }
+
+    emit prunePodsFinished(repository, bytesFreed);
+    return bytesFreed;
+}
+
 bool PodManager::createProject(QString repository) {
     if(!isGitRepository(repository)) {
         int gitInitResult = QProcess::execute(QString("git init \"%1\"").arg(repository));
@@ -398,7 +595,7 @@ bool PodManager::removePodSubmodule(QString repository, QString podName) {
     makeSureInRepositoryDirectory(repository);
     return runCommand(QString("git submodule deinit -f %1").arg(podName)) &&
         runCommand(QString("git rm -rf %1").arg(podName)) &&
-        runCommand(QString("rm -rf %1/.git/modules/%2").arg(repository).arg(podName)) &&
+        QDir(QString(".git/modules/%1").arg(podName)).removeRecursively() &&
         purgePodInfo(repository, podName);
 }
 
@@ -459,6 +656,57 @@ void PodManager::readPodInfo(QString repository, Pod& pod) {
     }
 }
 
+bool PodManager::readSubmodules(QString repository, QMap<QString, QString>& submodules) {
+    QFile file(QDir(repository).filePath(".gitmodules"));
+    if(!file.open(QFile::ReadOnly | QFile::Text)) {
+        return false;
+    }
+
+    // .gitmodules uses git's config format, one section per submodule:
+    // [submodule "<name>"]
+    //     path = <path>
+    QRegularExpression sectionPattern("^\\[\\s*submodule\\s+\"(.*)\"\\s*\\]$");
+    QString submoduleName;
+    bool inSubmoduleSection = false;
+    while(!file.atEnd()) {
+        QString line = QString::fromUtf8(file.readLine()).trimmed();
+        if(line.isEmpty() || line.startsWith('#') || line.startsWith(';')) {
+            continue;
+        }
+
+        if(line.startsWith('[')) {
+            QRegularExpressionMatch match = sectionPattern.match(line);
+            inSubmoduleSection = match.hasMatch();
+            submoduleName = match.captured(1);
+            continue;
+        }
+
+        int separator = line.indexOf('=');
+        if(!inSubmoduleSection || separator < 0) {
+            continue;
+        }
+
+        if(line.left(separator).trimmed().compare("path", Qt::CaseInsensitive) == 0) {
+            QString path = line.mid(separator + 1).trimmed();
+            if(path.length() >= 2 && path.startsWith('"') && path.endsWith('"')) {
+                path = path.mid(1, path.length() - 2);
+            }
+            submodules.insert(submoduleName, path);
+        }
+    }
+    return true;
+}
+
+qint64 PodManager::removeDirectory(QString path) {
+    qint64 size = directorySize(path);
+    if(QDir(path).removeRecursively()) {
+        return size;
+    }
+
+    // Removal stopped partway, only count what is actually gone
+    return size - directorySize(path);
+}
+
 bool PodManager::stageFile(QString repository, QString fileName) {
     makeSureInRepositoryDirectory(repository);
     return runCommand(QString("git add %1").arg(fileName));
@@ -26,6 +26,7 @@
 // Qt includes
 #include <QString>
 #include <QObject>
+#include <QMap>
 #include <QNetworkAccessManager>
 
 /**
@@ -96,6 +97,26 @@ public slots:
      */
     bool checkPod(QString repository, QString podName);
 
+    /**
+     * Checks all installed pods of a repository in parallel. Performs the
+     * same checks as checkPod, but reads each pod directory only once.
+     * Pods are taken from the paths in .gitmodules.
+     * @param repository
+     * @returns a report for each installed pod.
+     */
+    QList<PodCheckReport> checkPods(QString repository);
+
+    /**
+     * Removes leftovers of pods that are no longer registered in the
+     * repository's .gitmodules, ie.
+     * - orphaned module object stores in .git/modules
+     * - dangling pod checkouts whose .git file points into .git/modules
+     * Does nothing if .gitmodules cannot be read.
+     * @param repository
+     * @returns the number of bytes freed.
+     */
+    qint64 prunePods(QString repository);
+
     /**
      * Creates an empty QtPods project.
      * @param repository The target repository.
@@ -118,6 +139,8 @@ signals:
     void generatePodsSubdirsPriFinished(QString repository);
     void generateSubdirsProFinished(QString repository);
     void checkPodFinished(QString repository, QString podName, bool isValidPod);
+    void checkPodsFinished(QString repository, QList<PodCheckReport> reports);
+    void prunePodsFinished(QString repository, qint64 bytesFreed);
     void createProjectFinished(QString repository, bool success);
 
 private:
@@ -131,6 +154,16 @@ private:
     bool writePodInfo(QString repository, Pod pod);
     void readPodInfo(QString repository, Pod& pod);
 
+    /**
+     * Reads the submodules registered in the repository's .gitmodules.
+     * @param submodules Maps submodule names to their paths.
+     * @returns false if .gitmodules could not be read.
+     */
+    bool readSubmodules(QString repository, QMap<QString, QString>& submodules);
+
+    /** Removes a directory recursively. @returns the number of bytes freed. */
+    qint64 removeDirectory(QString path);
+
     bool stageFile(QString repository, QString fileName);
     void waitForReply(QNetworkReply *reply);
 
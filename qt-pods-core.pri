@@ -3,3 +3,6 @@ INCLUDEPATH += \
 
 LIBS += \
     -L../qt-pods-core -lqt-pods-core
+
+QT += \
+    concurrent
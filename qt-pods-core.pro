@@ -18,7 +18,7 @@
 ##                                                                           ##
 ###############################################################################
 
-QT += core widgets network
+QT += core widgets network concurrent
 
 TEMPLATE = lib
 CONFIG += staticlib